@@ -6,6 +6,7 @@
  *   - Periodic sensor sampling
  *   - Temperature history and averaging
  *   - Status determination (OK, DOOR_OPEN, TOO_WARM, ERROR)
+ *   - Feeding the thermal model (cooling/warming time constants)
  *   - Serial telemetry output
  * 
  * Design Philosophy:
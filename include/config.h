@@ -14,6 +14,18 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+// =============================================================================
+// FIRMWARE IDENTITY
+// =============================================================================
+
+/**
+ * Firmware version string
+ * 
+ * Shown in the startup banner and sent in the "hello" identity record
+ * (see probe_id.h). Bump this when the telemetry format changes.
+ */
+#define FIRMWARE_VERSION        "1.3"
+
 // =============================================================================
 // PIN ASSIGNMENTS
 // =============================================================================
@@ -113,6 +125,68 @@
 #define TEMP_VALID_MIN_C        (-40.0f)    // TMP36 minimum
 #define TEMP_VALID_MAX_C        (125.0f)    // TMP36 maximum
 
+// =============================================================================
+// THERMAL MODEL (time constant estimation)
+// =============================================================================
+
+/**
+ * Number of samples averaged into one thermal model block
+ * 
+ * Single ADC readings are too noisy to fit directly. With 2-second
+ * sampling, 10 samples = one block every 20 seconds. Blocks must stay
+ * short enough that a compressor-on run (often only 4-5 minutes) still
+ * holds several of them.
+ */
+#define THERMAL_BLOCK_SAMPLES   10
+
+/**
+ * Distance, in blocks, between the two temperatures of each fitted pair
+ * 
+ * The fit compares the temperature now with the one LAG blocks earlier.
+ * Over one block the fridge barely moves and ADC steps swamp the change;
+ * 6 blocks = 2 minutes gives a much larger change to measure, while still
+ * fitting inside one compressor-on run.
+ */
+#define THERMAL_LAG_BLOCKS      6
+
+/**
+ * Forgetting factor, as a power of two
+ * 
+ * Older pairs are weighted by (1 - 2^-SHIFT) per new pair. With 11 that is
+ * roughly the last 2048 pairs: about a day of compressor-off data, several
+ * days of compressor-on data. Time constants drift over weeks, so a long
+ * memory costs little and keeps the warming fit steady. Max 12.
+ */
+#define THERMAL_FORGETTING_SHIFT    11
+
+/**
+ * Temperature change (Celsius, over two blocks) that decides the regime
+ * 
+ * Falling by more than this → COOLING (compressor on)
+ * Rising by more than this  → WARMING (compressor off)
+ * Anything in between keeps the previous regime (hysteresis).
+ */
+#define THERMAL_TREND_C         0.05f
+
+/**
+ * Smallest temperature range (Celsius) a segment must cover to be fitted
+ * 
+ * A segment is one uninterrupted run of one regime. Short runs (e.g. the
+ * few minutes between a door closing and the compressor starting) cover
+ * too little range to separate tau from T_inf and are dropped.
+ */
+#define THERMAL_MIN_SPAN_C      1.0f
+
+/**
+ * Updates required before a regime's fit is reported as valid
+ */
+#define THERMAL_MIN_UPDATES     20
+
+/**
+ * How often to print the thermal model line (in milliseconds)
+ */
+#define THERMAL_PRINT_INTERVAL_MS   60000
+
 // =============================================================================
 // DOOR SENSOR DEBOUNCING
 // =============================================================================
@@ -188,5 +262,16 @@
 #define TMP36_OFFSET_V          0.5f    // Voltage at 0°C
 #define TMP36_SCALE             100.0f  // °C per volt (1 / 10mV)
 
+/**
+ * Temperature Calibration Offset (Celsius)
+ * 
+ * Added to every reading. Measure the probe against a reference
+ * thermometer in the fridge and set this to (reference - probe).
+ * 
+ * This is the power-on default; sensors_set_calibration_offset()
+ * can change it at runtime.
+ */
+#define TEMP_CALIBRATION_OFFSET_C   0.0f
+
 #endif // CONFIG_H
 
@@ -0,0 +1,59 @@
+/**
+ * @file probe_id.h
+ * @brief Probe identity "hello" record for the Community Fridge Probe
+ *
+ * Probes get moved between USB ports, and /dev/ttyACM0 today may be a
+ * different fridge tomorrow. To let the host tell probes apart without
+ * any manual configuration, the firmware announces who it is with a
+ * single compact line:
+ *
+ *   hello id=E6614103E7452D2F fw=1.3 fw_hash=5A1C03D2 cfg_hash=9B0E44A1
+ *
+ * Fields:
+ *   - id:       RP2040 flash chip unique ID (pico_unique_board_id), 16 hex
+ *               digits. Stable for the life of the board.
+ *   - fw:       FIRMWARE_VERSION from config.h
+ *   - fw_hash:  FNV-1a hash of the flashed program image. Changes whenever
+ *               the firmware is rebuilt with different code.
+ *   - cfg_hash: FNV-1a hash of the config.h values that affect telemetry
+ *               (pins, intervals, thresholds, thermal model settings)
+ *               plus the calibration offset currently in use. Lets the
+ *               host spot probes running with non-standard settings or a
+ *               changed calibration.
+ *
+ * When is it sent?
+ *   - Once at startup
+ *   - Every time the host opens the USB serial port (connect edge), so a
+ *     bridge that attaches to an already-running probe learns its
+ *     identity on the first line it reads.
+ */
+
+#ifndef PROBE_ID_H
+#define PROBE_ID_H
+
+#include <stdint.h>
+
+/**
+ * @brief Initialize the probe identity module
+ *
+ * Reads the board's unique ID and hashes the program image. That takes a
+ * few milliseconds, so it is done once here rather than every time the
+ * hello line is printed. (The config hash is cheap and is recomputed per
+ * hello, so runtime calibration changes show up.)
+ */
+void probe_id_init(void);
+
+/**
+ * @brief Watch for the host opening the serial port
+ *
+ * Call from the main loop. When the USB serial connection goes from
+ * "not connected" to "connected", the hello record is printed.
+ */
+void probe_id_update(void);
+
+/**
+ * @brief Print the hello record to serial output
+ */
+void probe_id_print_hello(void);
+
+#endif // PROBE_ID_H
@@ -13,6 +13,7 @@
 #define SENSORS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief Initialize the temperature sensor subsystem
@@ -25,14 +26,17 @@
  *   1. Enables the ADC peripheral (it's off by default to save power)
  *   2. Configures the GPIO pin as ADC input (disables digital functions)
  *   3. Selects the correct ADC channel
+ *   4. Builds the raw-code → temperature conversion table
  */
 void sensors_init(void);
 
 /**
  * @brief Read the current temperature from the sensor
  * 
- * Reads the ADC, converts to voltage, then converts to temperature using
- * the TMP36 formula: Temperature = (Voltage - 0.5V) * 100
+ * Reads the ADC and looks the raw code up in the conversion table built
+ * by sensors_init(). The table already holds the TMP36 formula
+ * (Temperature = (Voltage - 0.5V) * 100) plus the calibration offset for
+ * every possible code, so no float math happens per sample.
  * 
  * @return Temperature in degrees Celsius as a float.
  *         Returns values in approximately the range -40°C to +125°C.
@@ -47,6 +51,40 @@ void sensors_init(void);
  */
 float sensors_read_temperature_c(void);
 
+/**
+ * @brief Change the calibration offset and rebuild the conversion table
+ * 
+ * The offset is folded into the conversion table, so changing it means
+ * recomputing all ADC_RESOLUTION entries (a few milliseconds). Call this
+ * only when the calibration actually changes, not per sample.
+ * 
+ * @param offset_c Degrees Celsius added to every reading
+ */
+void sensors_set_calibration_offset(float offset_c);
+
+/**
+ * @brief Get the calibration offset currently applied to readings
+ * 
+ * @return Degrees Celsius added to every reading
+ */
+float sensors_get_calibration_offset(void);
+
+// Passes over all ADC codes per sensors_measure_conversion() call
+#define SENSORS_MEASURE_PASSES  16
+
+/**
+ * @brief Time the table lookup against the old float conversion
+ * 
+ * Converts every ADC code (ADC_RESOLUTION of them) through the
+ * conversion table and with the float math the table replaced,
+ * SENSORS_MEASURE_PASSES times each. No ADC reads are done, so only the
+ * conversion cost is measured. Takes a few tens of milliseconds.
+ * 
+ * @param table_us Filled with microseconds for all table conversions
+ * @param float_us Filled with microseconds for all float conversions
+ */
+void sensors_measure_conversion(uint32_t *table_us, uint32_t *float_us);
+
 /**
  * @brief Check if a temperature reading is valid
  * 
@@ -0,0 +1,108 @@
+/**
+ * @file thermal_model.h
+ * @brief Online estimate of the fridge's thermal time constants
+ *
+ * A fridge cabinet behaves (roughly) like a first-order RC circuit:
+ * the air temperature moves exponentially towards an equilibrium
+ * temperature T_inf with a time constant tau.
+ *
+ *   dT/dt = (T_inf - T) / tau
+ *
+ * There are two very different regimes:
+ *   - COOLING (compressor running):  T_inf is cold, tau is short
+ *   - WARMING (compressor off):      T_inf is near room temperature,
+ *                                    tau is long (insulation quality)
+ *
+ * This module fits that model separately for each regime from the
+ * temperature stream, using a recursive least squares style estimate in
+ * fixed-point arithmetic. The cost per sample is a few multiplies, plus
+ * O(log n) for the n pairs of a run when the compressor switches, and
+ * only a few block averages are stored.
+ *
+ * Why it's useful:
+ *   - tau_warm getting shorter → door seal or insulation degrading
+ *   - tau_cool getting longer, or T_inf (cooling) creeping up → compressor
+ *     or condenser losing capacity, long before the fridge gets too warm
+ *
+ * The firmware has no compressor sensor, so the regime is inferred from
+ * the temperature trend. Samples taken while the door is open (or with
+ * a sensor error) are excluded, since the model doesn't apply then.
+ */
+
+#ifndef THERMAL_MODEL_H
+#define THERMAL_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Thermal regime inferred from the temperature trend
+ */
+typedef enum {
+    THERMAL_REGIME_NONE,     // Not enough undisturbed data yet (or door open)
+    THERMAL_REGIME_COOLING,  // Temperature falling - compressor running
+    THERMAL_REGIME_WARMING   // Temperature rising - compressor off
+} thermal_regime_t;
+
+/**
+ * Fitted model for one regime
+ */
+typedef struct {
+    bool valid;               // Enough updates and a physically sensible fit
+    uint32_t tau_s;           // Time constant in seconds
+    int32_t t_inf_centi_c;    // Equilibrium temperature in 0.01°C units
+    uint32_t updates;         // Number of pairs fitted so far
+} thermal_fit_t;
+
+/**
+ * @brief Reset the estimator (forget all fits)
+ */
+void thermal_model_init(void);
+
+/**
+ * @brief Feed one temperature sample into the estimator
+ *
+ * Call once per sensor sample (every SAMPLE_INTERVAL_MS). Samples are
+ * averaged in blocks of THERMAL_BLOCK_SAMPLES; each regime's fit is
+ * updated when a run of that regime ends.
+ *
+ * @param temp_c     Temperature reading in degrees Celsius
+ * @param door_open  true if the door is open (block is discarded)
+ * @param valid      false if the reading is a sensor error (block is discarded)
+ * @return true if this sample completed a block (the estimates may have changed)
+ */
+bool thermal_model_add_sample(float temp_c, bool door_open, bool valid);
+
+/**
+ * @brief Get the regime the most recent block was assigned to
+ */
+thermal_regime_t thermal_model_get_regime(void);
+
+/**
+ * @brief Get the current fit for a regime
+ *
+ * @param regime THERMAL_REGIME_COOLING or THERMAL_REGIME_WARMING
+ * @param out    Filled with the fit; out->valid is false until the
+ *               estimate has settled, and whenever it is outside
+ *               tau <= 1 day, |T_inf| <= 100°C
+ */
+void thermal_model_get_fit(thermal_regime_t regime, thermal_fit_t *out);
+
+/**
+ * @brief Estimated cooling capacity at the alarm threshold
+ *
+ * How fast the running compressor pulls the cabinet down when it is at
+ * TEMP_OK_MAX_C: (TEMP_OK_MAX_C - T_inf_cool) / tau_cool. A falling value
+ * over days or weeks means the fridge is losing cooling capacity.
+ *
+ * @param centi_c_per_hour Filled with the capacity in 0.01°C per hour
+ * @return true if the cooling fit is valid, false otherwise
+ */
+bool thermal_model_get_cooling_capacity(int32_t *centi_c_per_hour);
+
+/**
+ * @brief Convert a regime to a human-readable string
+ */
+const char* thermal_model_regime_to_string(thermal_regime_t regime);
+
+#endif // THERMAL_MODEL_H
@@ -39,6 +39,7 @@
 #include "sensors.h"
 #include "door_sensor.h"
 #include "led_status.h"
+#include "thermal_model.h"
 
 #include <stdio.h>   // For printf (serial output)
 #include <string.h>  // For memset
@@ -61,6 +62,7 @@ static status_t current_status = STATUS_OK;
 // Timing state
 static uint32_t last_sample_ms = 0;
 static uint32_t last_telemetry_ms = 0;
+static uint32_t last_thermal_ms = 0;
 static bool first_update = true;
 
 // =============================================================================
@@ -132,17 +134,78 @@ static status_t determine_status(void) {
 /**
  * @brief Print telemetry line to serial output
  * 
- * Format: t=4.3C, avg=4.1C, door=open, status=OK
+ * Format: t=4.3C, avg=4.1C, door=open, status=OK, ms=123456, now=124006
  * 
  * This is designed to be easily parseable by both humans and scripts.
  * One reading per line, comma-separated fields.
+ * 
+ * ms= is the time (milliseconds since boot) the reported sample was
+ * taken, not the time the line was printed. Telemetry and sampling run
+ * on different intervals, so the host needs this to place readings on a
+ * common time axis with other probes. now= is the time the line was
+ * printed, which the host pairs with its receive time to map probe time
+ * to wall-clock time. Both wrap after ~49 days.
+ * 
+ * @param now_ms Current time in milliseconds since boot
  */
-static void print_telemetry(void) {
-    printf("t=%.1fC, avg=%.1fC, door=%s, status=%s\n",
+static void print_telemetry(uint32_t now_ms) {
+    printf("t=%.1fC, avg=%.1fC, door=%s, status=%s, ms=%lu, now=%lu\n",
            current_temp,
            average_temp,
            door_open ? "open" : "closed",
-           led_status_to_string(current_status));
+           led_status_to_string(current_status),
+           (unsigned long)last_sample_ms,
+           (unsigned long)now_ms);
+}
+
+/**
+ * @brief Print one regime's fit as "tau_<name>=842s tinf_<name>=-1.20C"
+ * 
+ * Fits that haven't settled yet are printed as "-".
+ */
+static void print_thermal_fit(const char *name, thermal_regime_t regime) {
+    thermal_fit_t fit;
+    thermal_model_get_fit(regime, &fit);
+    
+    if (fit.valid) {
+        printf(" tau_%s=%lus tinf_%s=%.2fC",
+               name, (unsigned long)fit.tau_s,
+               name, (double)fit.t_inf_centi_c / 100.0);
+    } else {
+        printf(" tau_%s=- tinf_%s=-", name, name);
+    }
+}
+
+/**
+ * @brief Print the thermal model estimates to serial output
+ * 
+ * Format: thermal regime=cooling tau_cool=842s tinf_cool=-1.20C
+ *         tau_warm=5400s tinf_warm=21.50C cap=35.10C/h
+ * (all on one line)
+ * 
+ * Printed every THERMAL_PRINT_INTERVAL_MS. Like the hello record, it
+ * starts with a keyword so host scripts can tell it apart from telemetry.
+ */
+static void print_thermal_model(void) {
+    int32_t capacity;
+    
+    printf("thermal regime=%s",
+           thermal_model_regime_to_string(thermal_model_get_regime()));
+    print_thermal_fit("cool", THERMAL_REGIME_COOLING);
+    print_thermal_fit("warm", THERMAL_REGIME_WARMING);
+    if (thermal_model_get_cooling_capacity(&capacity)) {
+        printf(" cap=%.2fC/h\n", (double)capacity / 100.0);
+    } else {
+        printf(" cap=-\n");
+    }
+}
+
+/**
+ * @brief Feed the latest sample to the thermal model
+ */
+static void update_thermal_model(void) {
+    thermal_model_add_sample(current_temp, door_open,
+                             sensors_is_reading_valid(current_temp));
 }
 
 // =============================================================================
@@ -161,9 +224,13 @@ void app_init(void) {
     door_open = false;
     current_status = STATUS_OK;
     
+    // Forget any thermal model fits
+    thermal_model_init();
+    
     // Reset timing
     last_sample_ms = 0;
     last_telemetry_ms = 0;
+    last_thermal_ms = 0;
     first_update = true;
 }
 
@@ -176,6 +243,7 @@ void app_update(uint32_t millis_since_boot) {
     if (first_update) {
         last_sample_ms = millis_since_boot;
         last_telemetry_ms = millis_since_boot;
+        last_thermal_ms = millis_since_boot;
         first_update = false;
         
         // Take initial readings
@@ -185,10 +253,11 @@ void app_update(uint32_t millis_since_boot) {
         door_open = door_sensor_is_open();  // Now returns immediately (non-blocking)
         current_status = determine_status();
         led_status_set(current_status);
+        update_thermal_model();
         
         // Print initial telemetry
         printf("=== Fridge Probe Started ===\n");
-        print_telemetry();
+        print_telemetry(millis_since_boot);
         return;
     }
     
@@ -207,12 +276,21 @@ void app_update(uint32_t millis_since_boot) {
         // Determine and set status
         current_status = determine_status();
         led_status_set(current_status);
+        
+        // Track cooling/warming time constants
+        update_thermal_model();
     }
     
     // Check if it's time to print telemetry
     if ((millis_since_boot - last_telemetry_ms) >= TELEMETRY_INTERVAL_MS) {
         last_telemetry_ms = millis_since_boot;
-        print_telemetry();
+        print_telemetry(millis_since_boot);
+    }
+    
+    // Check if it's time to print the thermal model
+    if ((millis_since_boot - last_thermal_ms) >= THERMAL_PRINT_INTERVAL_MS) {
+        last_thermal_ms = millis_since_boot;
+        print_thermal_model();
     }
 }
 
@@ -58,6 +58,7 @@
 #include "door_sensor.h"
 #include "led_status.h"
 #include "app_logic.h"
+#include "probe_id.h"
 
 /**
  * @brief Get current time in milliseconds since boot
@@ -111,7 +112,7 @@ int main(void) {
     printf("\n");
     printf("========================================\n");
     printf("  Community Fridge Probe Firmware\n");
-    printf("  v1.0 - Raspberry Pi Pico (RP2040)\n");
+    printf("  v%s - Raspberry Pi Pico (RP2040)\n", FIRMWARE_VERSION);
     printf("========================================\n");
     printf("\n");
     printf("Pin assignments:\n");
@@ -137,9 +138,22 @@ int main(void) {
     printf("Initializing hardware...\n");
     
     // Initialize temperature sensor (ADC)
+    // (also builds the ADC conversion table - timed so its cost is visible)
     printf("  - ADC (temperature sensor)... ");
+    uint64_t sensors_start_us = time_us_64();
     sensors_init();
-    printf("OK\n");
+    printf("OK (%lu us)\n", (unsigned long)(time_us_64() - sensors_start_us));
+    
+    // Report what the conversion table saves per read, measured on this chip
+    uint32_t table_us, float_us;
+    uint32_t conversions = (uint32_t)ADC_RESOLUTION * SENSORS_MEASURE_PASSES;
+    sensors_measure_conversion(&table_us, &float_us);
+    printf("    conversion table: %u bytes RAM, %lu ns per read "
+           "(float math: %lu ns, %lu conversions each)\n",
+           (unsigned)(ADC_RESOLUTION * sizeof(int16_t)),
+           (unsigned long)(((uint64_t)table_us * 1000u) / conversions),
+           (unsigned long)(((uint64_t)float_us * 1000u) / conversions),
+           (unsigned long)conversions);
     
     // Initialize door sensor (GPIO input)
     printf("  - GPIO (door sensor)... ");
@@ -158,7 +172,13 @@ int main(void) {
     app_init();
     printf("OK\n");
     
+    // Compute board ID and firmware/config hashes for the hello record
+    printf("  - Probe identity... ");
+    probe_id_init();
+    printf("OK\n");
+    
     printf("\n");
+    probe_id_print_hello();
     printf("Initialization complete. Starting main loop.\n");
     printf("\n");
     
@@ -191,6 +211,9 @@ int main(void) {
         // This handles sensor sampling, status determination, and telemetry
         app_update(millis);
         
+        // Re-send the hello record whenever the host opens the serial port
+        probe_id_update();
+        
         // Small delay to prevent tight spinning
         // 10ms gives us:
         //   - 100 iterations per second
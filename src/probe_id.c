@@ -0,0 +1,161 @@
+/**
+ * @file probe_id.c
+ * @brief Probe identity hello record: unique board ID plus firmware/config hashes
+ *
+ * Where the values come from:
+ * ---------------------------
+ * - The RP2040 itself has no serial number, but every Pico's QSPI flash
+ *   chip has a factory-programmed 64-bit unique ID. The SDK reads it at
+ *   boot and exposes it via pico_get_unique_board_id_string().
+ *
+ * - The linker script marks the start and end of the program image in
+ *   flash (__flash_binary_start / __flash_binary_end). Hashing that range
+ *   gives a fingerprint of exactly the code that is running, without
+ *   needing the build system to inject a git hash.
+ *
+ * - The config hash covers the config.h values that change how telemetry
+ *   should be interpreted. They are copied into a const struct so the
+ *   hash is over their actual compiled values. The calibration offset can
+ *   also be changed at runtime, so the active offset is read from the
+ *   sensors module and hashed each time the hello record is printed.
+ *
+ * Hash Function:
+ * --------------
+ * FNV-1a (32-bit) is used because it is tiny, has no tables, and is good
+ * enough to tell builds apart. It is NOT a security measure.
+ */
+
+#include "probe_id.h"
+#include "config.h"
+#include "sensors.h"   // For sensors_get_calibration_offset()
+
+#include <stdio.h>   // For printf (serial output)
+
+// Pico SDK headers
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"    // For stdio_usb_connected()
+#include "pico/unique_id.h"    // For pico_get_unique_board_id_string()
+
+// Program image bounds, provided by the Pico SDK linker script
+extern char __flash_binary_start;
+extern char __flash_binary_end;
+
+// =============================================================================
+// Internal state
+// =============================================================================
+
+// 16 hex digits + terminator
+static char board_id[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+
+static uint32_t firmware_hash = 0;
+
+// FNV-1a offset basis (starting value for a new hash)
+#define FNV1A_32_INIT   2166136261u
+
+// Last observed USB connection state (for edge detection)
+static bool usb_was_connected = false;
+
+/**
+ * Config values included in cfg_hash. All fields are 32 bits wide so the
+ * struct has no padding bytes that could make the hash unstable.
+ */
+typedef struct {
+    int32_t temp_sensor_pin;
+    int32_t door_sensor_pin;
+    int32_t status_led_pin;
+    int32_t sample_interval_ms;
+    int32_t telemetry_interval_ms;
+    int32_t history_buffer_size;
+    float   temp_ok_max_c;
+    float   temp_valid_min_c;
+    float   temp_valid_max_c;
+    int32_t debounce_samples;
+    float   temp_calibration_offset_c;  // Default; the active one is hashed too
+    int32_t thermal_block_samples;
+    int32_t thermal_lag_blocks;
+    int32_t thermal_forgetting_shift;
+    float   thermal_trend_c;
+    float   thermal_min_span_c;
+    int32_t thermal_min_updates;
+    int32_t thermal_print_interval_ms;
+} config_fingerprint_t;
+
+static const config_fingerprint_t config_fingerprint = {
+    .temp_sensor_pin       = TEMP_SENSOR_PIN,
+    .door_sensor_pin       = DOOR_SENSOR_PIN,
+    .status_led_pin        = STATUS_LED_PIN,
+    .sample_interval_ms    = SAMPLE_INTERVAL_MS,
+    .telemetry_interval_ms = TELEMETRY_INTERVAL_MS,
+    .history_buffer_size   = HISTORY_BUFFER_SIZE,
+    .temp_ok_max_c         = TEMP_OK_MAX_C,
+    .temp_valid_min_c      = TEMP_VALID_MIN_C,
+    .temp_valid_max_c      = TEMP_VALID_MAX_C,
+    .debounce_samples      = DEBOUNCE_SAMPLES,
+    .temp_calibration_offset_c = TEMP_CALIBRATION_OFFSET_C,
+    .thermal_block_samples     = THERMAL_BLOCK_SAMPLES,
+    .thermal_lag_blocks        = THERMAL_LAG_BLOCKS,
+    .thermal_forgetting_shift  = THERMAL_FORGETTING_SHIFT,
+    .thermal_trend_c           = THERMAL_TREND_C,
+    .thermal_min_span_c        = THERMAL_MIN_SPAN_C,
+    .thermal_min_updates       = THERMAL_MIN_UPDATES,
+    .thermal_print_interval_ms = THERMAL_PRINT_INTERVAL_MS,
+};
+
+// =============================================================================
+// Internal helper functions
+// =============================================================================
+
+/**
+ * @brief 32-bit FNV-1a hash over a block of memory
+ * 
+ * @param hash FNV1A_32_INIT for a new hash, or a previous result to
+ *             continue hashing more data
+ */
+static uint32_t fnv1a_32(uint32_t hash, const uint8_t *data, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;         // FNV prime
+    }
+    return hash;
+}
+
+// =============================================================================
+// Public API implementation
+// =============================================================================
+
+void probe_id_init(void) {
+    pico_get_unique_board_id_string(board_id, sizeof(board_id));
+
+    // Reading flash through XIP is just a memory read
+    const uint8_t *image = (const uint8_t *)&__flash_binary_start;
+    uint32_t image_len = (uint32_t)(&__flash_binary_end - &__flash_binary_start);
+    firmware_hash = fnv1a_32(FNV1A_32_INIT, image, image_len);
+
+    usb_was_connected = stdio_usb_connected();
+}
+
+void probe_id_update(void) {
+    bool connected = stdio_usb_connected();
+
+    // Announce ourselves on the rising edge: the host just opened the port
+    if (connected && !usb_was_connected) {
+        probe_id_print_hello();
+    }
+    usb_was_connected = connected;
+}
+
+void probe_id_print_hello(void) {
+    // Compile-time config, then the calibration offset actually in use
+    float offset_c = sensors_get_calibration_offset();
+    uint32_t config_hash = fnv1a_32(FNV1A_32_INIT,
+                                    (const uint8_t *)&config_fingerprint,
+                                    sizeof(config_fingerprint));
+    config_hash = fnv1a_32(config_hash, (const uint8_t *)&offset_c,
+                           sizeof(offset_c));
+
+    printf("hello id=%s fw=%s fw_hash=%08lX cfg_hash=%08lX\n",
+           board_id,
+           FIRMWARE_VERSION,
+           (unsigned long)firmware_hash,
+           (unsigned long)config_hash);
+}
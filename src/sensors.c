@@ -15,6 +15,40 @@
  * 1. Forgetting to call adc_init() - the ADC is disabled by default
  * 2. Not configuring the GPIO for ADC use with adc_gpio_init()
  * 3. Reading from the wrong channel (channels are 0-indexed, not by GPIO number)
+ * 
+ * Conversion Table:
+ * -----------------
+ * The ADC can only ever return 4096 different codes, so instead of doing
+ * the voltage and TMP36 math (in software floating point - the RP2040 has
+ * no FPU) on every sample, we do it once for every code at startup and
+ * store the results:
+ * 
+ *   raw code ──► temp_table_centi_c[raw] ──► temperature (0.01°C units)
+ * 
+ * Cost/benefit:
+ *   - RAM: ADC_RESOLUTION x int16_t = 8192 bytes (about 3% of the RP2040's
+ *     264 KB)
+ *   - Build time: one pass of the old per-sample math per code, at boot
+ *     and on every calibration change
+ *   - Per sample: a halfword load, an int→float conversion and a multiply,
+ *     instead of an int→float conversion, two multiplies, a subtract and
+ *     an add (the calibration offset)
+ * 
+ * Measured:
+ *   sensors_measure_conversion() converts all 4096 codes both ways,
+ *   SENSORS_MEASURE_PASSES times over, so on the RP2040 each total runs to
+ *   milliseconds - far above the 1 us timer resolution. main() prints the
+ *   result at every boot ("conversion table: ... ns per read"), so the
+ *   numbers come from the RP2040's own startup log, soft-float and all.
+ * 
+ * At one sample every SAMPLE_INTERVAL_MS the cycles saved are small; the
+ * main benefit is that anything code-dependent (calibration today, ADC
+ * DNL correction if it's ever characterised) is folded into the table
+ * once and costs nothing at read time.
+ * 
+ * Centi-degrees (int16_t) cover -327.68°C..327.67°C, which holds every
+ * code (code 0 = -50°C, code 4095 ≈ 280°C) at 0.01°C resolution - finer
+ * than one ADC step (~0.08°C).
  */
 
 #include "sensors.h"
@@ -23,6 +57,80 @@
 // Pico SDK headers for hardware access
 #include "hardware/adc.h"      // ADC peripheral functions
 #include "hardware/gpio.h"     // GPIO configuration (used internally by adc_gpio_init)
+#include "pico/time.h"         // For time_us_64() (conversion benchmark)
+
+#include <stdint.h>
+
+// =============================================================================
+// Internal state
+// =============================================================================
+
+// Calibrated temperature for every raw ADC code, in hundredths of a °C
+static int16_t temp_table_centi_c[ADC_RESOLUTION];
+
+// Calibration offset currently folded into the table
+static float calibration_offset_c = TEMP_CALIBRATION_OFFSET_C;
+
+// =============================================================================
+// Internal helper functions
+// =============================================================================
+
+/**
+ * @brief Convert one raw ADC code to °C with float math
+ * 
+ * This is the per-sample conversion the firmware used before the table.
+ * It is now only used to fill the table, and as the baseline for
+ * sensors_measure_conversion().
+ */
+static float convert_raw_float(uint16_t raw, float offset_c) {
+    float voltage = (float)raw * (ADC_VREF / (float)ADC_RESOLUTION);
+    return (voltage - TMP36_OFFSET_V) * TMP36_SCALE + offset_c;
+}
+
+/**
+ * @brief Look up one raw ADC code in the conversion table
+ */
+static inline float convert_raw_table(uint16_t raw) {
+    // Mask to 12 bits so a bad read can never index past the table
+    return (float)temp_table_centi_c[raw & (ADC_RESOLUTION - 1)] * 0.01f;
+}
+
+/**
+ * @brief Fill the conversion table for every possible ADC code
+ * 
+ * Conversion process (per code):
+ * 
+ * 1. ADC raw value (0-4095) represents 0V to 3.3V
+ *    voltage = raw_value * (3.3V / 4096)
+ * 
+ * 2. TMP36 outputs voltage linearly proportional to temperature:
+ *    - 0.5V at 0°C
+ *    - Increases by 10mV per °C (0.01V/°C)
+ *    - So: temperature = (voltage - 0.5) / 0.01
+ *    - Simplified: temperature = (voltage - 0.5) * 100
+ * 
+ * 3. Add the calibration offset, then round to the nearest 0.01°C
+ * 
+ * Example:
+ *    ADC reads 620 → voltage = 620 * (3.3/4096) = 0.5V → temp = 0°C
+ *    ADC reads 775 → voltage = 775 * (3.3/4096) = 0.625V → temp = 12.5°C
+ */
+static void build_conversion_table(float offset_c) {
+    calibration_offset_c = offset_c;
+    
+    for (int raw = 0; raw < ADC_RESOLUTION; raw++) {
+        float centi = convert_raw_float((uint16_t)raw, offset_c) * 100.0f;
+        
+        // Round half away from zero, clamped to the int16_t range
+        centi += (centi >= 0.0f) ? 0.5f : -0.5f;
+        if (centi > (float)INT16_MAX) {
+            centi = (float)INT16_MAX;
+        } else if (centi < (float)INT16_MIN) {
+            centi = (float)INT16_MIN;
+        }
+        temp_table_centi_c[raw] = (int16_t)centi;
+    }
+}
 
 /**
  * @brief Initialize the ADC for temperature sensing
@@ -50,25 +158,47 @@ void sensors_init(void) {
     // temperature sensor channel here. If you have multiple sensors,
     // you'd call adc_select_input() before each read.
     adc_select_input(TEMP_SENSOR_ADC_CHANNEL);
+    
+    // Step 4: Precompute the temperature for every ADC code
+    build_conversion_table(TEMP_CALIBRATION_OFFSET_C);
+}
+
+void sensors_set_calibration_offset(float offset_c) {
+    build_conversion_table(offset_c);
+}
+
+float sensors_get_calibration_offset(void) {
+    return calibration_offset_c;
+}
+
+void sensors_measure_conversion(uint32_t *table_us, uint32_t *float_us) {
+    // Results go to a volatile so the compiler can't skip the work
+    volatile float sink = 0.0f;
+    
+    uint64_t start_us = time_us_64();
+    for (int pass = 0; pass < SENSORS_MEASURE_PASSES; pass++) {
+        for (int raw = 0; raw < ADC_RESOLUTION; raw++) {
+            sink = convert_raw_table((uint16_t)raw);
+        }
+    }
+    *table_us = (uint32_t)(time_us_64() - start_us);
+    
+    start_us = time_us_64();
+    for (int pass = 0; pass < SENSORS_MEASURE_PASSES; pass++) {
+        for (int raw = 0; raw < ADC_RESOLUTION; raw++) {
+            sink = convert_raw_float((uint16_t)raw, calibration_offset_c);
+        }
+    }
+    *float_us = (uint32_t)(time_us_64() - start_us);
+    
+    (void)sink;
 }
 
 /**
  * @brief Read temperature from the TMP36 sensor
  * 
- * Conversion process:
- * 
- * 1. ADC raw value (0-4095) represents 0V to 3.3V
- *    voltage = raw_value * (3.3V / 4096)
- * 
- * 2. TMP36 outputs voltage linearly proportional to temperature:
- *    - 0.5V at 0°C
- *    - Increases by 10mV per °C (0.01V/°C)
- *    - So: temperature = (voltage - 0.5) / 0.01
- *    - Simplified: temperature = (voltage - 0.5) * 100
- * 
- * Example:
- *    ADC reads 620 → voltage = 620 * (3.3/4096) = 0.5V → temp = 0°C
- *    ADC reads 775 → voltage = 775 * (3.3/4096) = 0.625V → temp = 12.5°C
+ * All the conversion work was done by build_conversion_table(), so this
+ * is just an ADC read and a table lookup.
  */
 float sensors_read_temperature_c(void) {
     // Ensure we're reading from the correct channel
@@ -79,15 +209,8 @@ float sensors_read_temperature_c(void) {
     // This is a blocking call but only takes ~2 microseconds
     uint16_t raw = adc_read();
     
-    // Convert raw ADC value to voltage
-    // The ADC reference is 3.3V and resolution is 12 bits (4096 levels)
-    float voltage = (float)raw * (ADC_VREF / (float)ADC_RESOLUTION);
-    
-    // Convert voltage to temperature using TMP36 formula
-    // TMP36 outputs 0.5V at 0°C and increases by 10mV/°C
-    float temp_c = (voltage - TMP36_OFFSET_V) * TMP36_SCALE;
-    
-    return temp_c;
+    // Look up the calibrated temperature (0.01°C units)
+    return convert_raw_table(raw);
 }
 
 /**
@@ -0,0 +1,526 @@
+/**
+ * @file thermal_model.c
+ * @brief Fixed-point recursive least squares fit of a first-order thermal model
+ *
+ * The Model:
+ * ----------
+ * Sampling the continuous model dT/dt = (T_inf - T) / tau gives a simple
+ * linear recurrence between temperatures a fixed lag L apart:
+ *
+ *   T[k+L] = a * T[k] + b        where  a = e^(-L/tau)
+ *                                       b = (1 - a) * T_inf
+ *
+ * So if we can estimate a and b, we get:
+ *
+ *   tau   ~= L / (1 - a)    (minus a small correction, see get_fit)
+ *   T_inf  = b / (1 - a)
+ *
+ * Conditioning:
+ * -------------
+ * With the compressor off, a fridge warms towards room temperature with
+ * tau of an hour or more, but the thermostat turns it back on after only
+ * a couple of degrees. Over that range the curve is almost a straight
+ * line, and tau and T_inf are only told apart by its slight curvature.
+ * Three things keep the fit from drowning in ADC steps and noise:
+ *
+ *   - The lag L is THERMAL_LAG_BLOCKS blocks (minutes), not one block, so
+ *     T[k+L] - T[k] is many ADC steps rather than a fraction of one.
+ *   - Segments that span less than THERMAL_MIN_SPAN_C are dropped.
+ *   - Noise in T[k] biases plain least squares towards a = 0 (short tau).
+ *     Instead each pair is fitted with an instrumental variable: the
+ *     block z = T[k-1] just before x = T[k]. It tracks x closely but its
+ *     noise is independent of both x and y, so the bias cancels.
+ *
+ * Recursive Estimate:
+ * -------------------
+ * The instrumental variable solution only depends on six running sums:
+ *
+ *   S1 = sum(w)   Sz = sum(w*z)   Sx = sum(w*x)   Sy = sum(w*y)
+ *   Szx = sum(w*z*x)              Szy = sum(w*z*y)
+ *
+ *   a = cov(z, y) / cov(z, x)     b = mean(y) - a * mean(x)
+ *
+ * Every sum is scaled by the forgetting factor lambda =
+ * 1 - 2^-THERMAL_FORGETTING_SHIFT per pair, so a pair k steps old has
+ * weight w = lambda^k - the same weighting as exponentially weighted
+ * RLS. Keeping the sums ("information form") instead of the usual
+ * covariance matrix P keeps everything well inside int64_t, while P
+ * shrinks to a few LSBs in fixed point and loses all precision.
+ *
+ * Cost per block is a few multiplies and shifts - constant, with only
+ * THERMAL_LAG_BLOCKS + 1 block averages stored. Closing a segment ages
+ * the sums by lambda^n in one multiply each, with lambda^n found by
+ * repeated squaring (about log2(n) steps). The solve only happens when
+ * the fit is read.
+ *
+ * Fixed Point:
+ * ------------
+ * The RP2040 has no floating-point unit. Temperatures are Q16.16 °C
+ * (value * 65536 in an int32_t) and all sums are Q16.16 in int64_t.
+ * Temperatures are taken relative to THERMAL_CENTER_C before fitting,
+ * which keeps the numbers small.
+ *
+ * Segmentation:
+ * -------------
+ * Compressor-on and compressor-off follow different models, so each gets
+ * its own set of sums. Samples are averaged into blocks; the regime is
+ * picked from the temperature change over the last two blocks. Each
+ * uninterrupted run of one regime is a segment: its pairs are summed
+ * separately and folded into the regime's sums when it ends. Pairs wait
+ * in a short delay line first, so the ones that straddle a compressor
+ * switch (which the trend only reveals later), a door opening or a
+ * sensor error can be dropped.
+ */
+
+#include "thermal_model.h"
+#include "config.h"
+
+#include <string.h>  // For memset
+
+// =============================================================================
+// Fixed-point helpers
+// =============================================================================
+
+#define Q16_ONE             65536
+#define Q16_FROM_FLOAT(f)   ((int32_t)((f) * 65536.0f))
+
+// Constants derived from config.h (folded at compile time)
+#define THERMAL_TREND_Q16       Q16_FROM_FLOAT(THERMAL_TREND_C)
+#define THERMAL_MIN_SPAN_Q16    Q16_FROM_FLOAT(THERMAL_MIN_SPAN_C)
+#define THERMAL_BLOCK_S         ((SAMPLE_INTERVAL_MS * THERMAL_BLOCK_SAMPLES) / 1000)
+#define THERMAL_LAG_S           (THERMAL_BLOCK_S * THERMAL_LAG_BLOCKS)
+
+// Reference temperature subtracted before fitting, and the largest
+// offset from it the model accepts (keeps every product inside int64_t)
+#define THERMAL_CENTER_C        5
+#define THERMAL_MAX_OFFSET_Q16  (32 * Q16_ONE)
+
+// With |x| <= 32°C the largest product in thermal_model_get_fit() is
+// about 2^(49 + THERMAL_FORGETTING_SHIFT)
+#if THERMAL_FORGETTING_SHIFT > 12
+#error "THERMAL_FORGETTING_SHIFT > 12 can overflow the int64_t sums"
+#endif
+
+// Block pairs held back before fitting. The trend detector only notices a
+// compressor switch a couple of blocks late, so the newest pairs may belong
+// to the next regime; they are dropped if the regime changes meanwhile.
+#define THERMAL_PENDING_PAIRS   3
+
+// A long segment is merged in chunks of this many pairs, so one very long
+// warm-up can't outweigh the forgetting factor
+#define THERMAL_SEGMENT_MAX_PAIRS   (1 << (THERMAL_FORGETTING_SHIFT - 2))
+
+// Minimum weighted covariance of z and x (about the variance of the fitted
+// temperatures), (0.1°C)^2, before a fit is trusted. Below that the sums
+// can't tell a from b.
+#define THERMAL_MIN_VARIANCE_DIV    100
+
+// Fits outside these limits are reported as not valid. Beyond them the
+// model has clearly not settled, and the divisions could overflow.
+#define THERMAL_MAX_TAU_S       86400   // One day
+#define THERMAL_MAX_T_INF_C     100
+
+// lambda^n is applied as a Q8.24 factor. The sums stay below about
+// 2^(26 + THERMAL_FORGETTING_SHIFT), so sum * factor fits in int64_t.
+#define LAMBDA_FRAC_BITS        24
+#define LAMBDA_ONE              (1u << LAMBDA_FRAC_BITS)
+#define LAMBDA_Q24              (LAMBDA_ONE - (LAMBDA_ONE >> THERMAL_FORGETTING_SHIFT))
+
+/**
+ * @brief Drop 16 fractional bits, rounding to nearest
+ *
+ * A plain >> 16 always rounds down, which would bias the z*x and z*y sums.
+ */
+static inline int64_t q16_round(int64_t value) {
+    return (value + (1 << 15)) >> 16;
+}
+
+/**
+ * @brief lambda^n in Q8.24, by repeated squaring
+ */
+static uint32_t lambda_pow(uint32_t n) {
+    uint64_t result = LAMBDA_ONE;
+    uint64_t base = LAMBDA_Q24;
+
+    while (n > 0) {
+        if (n & 1u) {
+            result = (result * base + (LAMBDA_ONE >> 1)) >> LAMBDA_FRAC_BITS;
+        }
+        base = (base * base + (LAMBDA_ONE >> 1)) >> LAMBDA_FRAC_BITS;
+        n >>= 1;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * @brief Scale a sum by a Q8.24 factor, rounding to nearest
+ */
+static inline int64_t scale_q24(int64_t value, uint32_t factor) {
+    return (value * (int64_t)factor + (1 << (LAMBDA_FRAC_BITS - 1))) >> LAMBDA_FRAC_BITS;
+}
+
+// =============================================================================
+// Internal state
+// =============================================================================
+
+/**
+ * Instrumental variable sums (Q16.16), either exponentially weighted for a
+ * regime or plain for the segment being collected
+ */
+typedef struct {
+    int64_t s1;       // sum(w)
+    int64_t sz;       // sum(w * z)
+    int64_t sx;       // sum(w * x)
+    int64_t sy;       // sum(w * y)
+    int64_t szx;      // sum(w * z * x)
+    int64_t szy;      // sum(w * z * y)
+    uint32_t updates;
+} rls_state_t;
+
+// One estimator per regime (index 0 = THERMAL_REGIME_NONE, unused)
+static rls_state_t estimators[3];
+
+// Pairs from the current segment (one uninterrupted run of one regime),
+// and the temperature range it has covered so far
+static rls_state_t segment;
+static int32_t segment_min;
+static int32_t segment_max;
+
+// Current block accumulation
+static int32_t block_sum_centi = 0;
+static int block_count = 0;
+static bool block_disturbed = false;
+
+// Last two completed block averages (Q16 °C, relative to THERMAL_CENTER_C);
+// [0] is the most recent. Used for the trend.
+static int32_t block_avg[2];
+static int block_history = 0;
+
+// Block averages of the current segment, THERMAL_LAG_BLOCKS + 1 deep: the
+// oldest is the instrument z for the next pair, the one after it is x
+#define THERMAL_LAG_DEPTH   (THERMAL_LAG_BLOCKS + 1)
+static int32_t lag_avg[THERMAL_LAG_DEPTH];
+static int lag_head = 0;     // Oldest entry (next to be overwritten)
+static int lag_count = 0;
+
+// Regime of the most recent block
+static thermal_regime_t regime = THERMAL_REGIME_NONE;
+
+// Delay line of (z, x, y) pairs waiting to be fitted, oldest first
+static int32_t pending_z[THERMAL_PENDING_PAIRS];
+static int32_t pending_x[THERMAL_PENDING_PAIRS];
+static int32_t pending_y[THERMAL_PENDING_PAIRS];
+static int pending_count = 0;
+
+// =============================================================================
+// Internal helper functions
+// =============================================================================
+
+/**
+ * @brief Add the pair (x, y) and its instrument z to a set of sums
+ *
+ * @param z Block temperature just before x (Q16 °C, centered)
+ * @param x Block temperature (Q16 °C, centered)
+ * @param y Block temperature THERMAL_LAG_BLOCKS after x (Q16 °C, centered)
+ */
+static void sums_add(rls_state_t *sums, int32_t z, int32_t x, int32_t y) {
+    sums->s1  += Q16_ONE;
+    sums->sz  += z;
+    sums->sx  += x;
+    sums->sy  += y;
+    sums->szx += q16_round((int64_t)z * x);
+    sums->szy += q16_round((int64_t)z * y);
+    sums->updates++;
+}
+
+/**
+ * @brief Fold a finished segment into its regime's estimator
+ *
+ * The estimator is aged by lambda^n for the n pairs in the segment, as if
+ * the pairs had arrived one at a time, then the segment's sums are added.
+ * Segments that covered less than THERMAL_MIN_SPAN_C are dropped: over a
+ * range that small the ADC steps and noise swamp the curvature that
+ * separates tau from T_inf.
+ */
+static void close_segment(void) {
+    if (segment.updates > 0 && regime != THERMAL_REGIME_NONE &&
+        segment_max - segment_min >= THERMAL_MIN_SPAN_Q16) {
+        rls_state_t *rls = &estimators[regime];
+
+        // Forgetting: s *= lambda^n, one multiply per sum
+        uint32_t decay = lambda_pow(segment.updates);
+        rls->s1  = scale_q24(rls->s1,  decay);
+        rls->sz  = scale_q24(rls->sz,  decay);
+        rls->sx  = scale_q24(rls->sx,  decay);
+        rls->sy  = scale_q24(rls->sy,  decay);
+        rls->szx = scale_q24(rls->szx, decay);
+        rls->szy = scale_q24(rls->szy, decay);
+
+        rls->s1  += segment.s1;
+        rls->sz  += segment.sz;
+        rls->sx  += segment.sx;
+        rls->sy  += segment.sy;
+        rls->szx += segment.szx;
+        rls->szy += segment.szy;
+        rls->updates += segment.updates;
+    }
+
+    memset(&segment, 0, sizeof(segment));
+}
+
+/**
+ * @brief Start a new segment with one block and no pairs
+ */
+static void start_segment(int32_t avg) {
+    memset(&segment, 0, sizeof(segment));
+    segment_min = avg;
+    segment_max = avg;
+
+    lag_avg[0] = avg;
+    lag_head = 1;
+    lag_count = 1;
+    pending_count = 0;
+}
+
+/**
+ * @brief Queue a pair for the current segment, adding the oldest to the
+ *        segment sums once the delay line is full
+ */
+static void push_pair(int32_t z, int32_t x, int32_t y) {
+    if (pending_count == THERMAL_PENDING_PAIRS) {
+        sums_add(&segment, pending_z[0], pending_x[0], pending_y[0]);
+        for (int i = 1; i < THERMAL_PENDING_PAIRS; i++) {
+            pending_z[i - 1] = pending_z[i];
+            pending_x[i - 1] = pending_x[i];
+            pending_y[i - 1] = pending_y[i];
+        }
+        pending_count--;
+
+        if (segment.updates >= THERMAL_SEGMENT_MAX_PAIRS) {
+            close_segment();
+            segment_min = segment_max = y;
+        }
+    }
+    pending_z[pending_count] = z;
+    pending_x[pending_count] = x;
+    pending_y[pending_count] = y;
+    pending_count++;
+}
+
+/**
+ * @brief Add a block to the current segment: pair it with the block
+ *        THERMAL_LAG_BLOCKS earlier, then remember it
+ */
+static void extend_segment(int32_t avg) {
+    if (lag_count == THERMAL_LAG_DEPTH) {
+        // lag_head holds the oldest entry (z) once the buffer is full
+        push_pair(lag_avg[lag_head],
+                  lag_avg[(lag_head + 1) % THERMAL_LAG_DEPTH],
+                  avg);
+    } else {
+        lag_count++;
+    }
+    lag_avg[lag_head] = avg;
+    lag_head = (lag_head + 1) % THERMAL_LAG_DEPTH;
+
+    if (avg < segment_min) segment_min = avg;
+    if (avg > segment_max) segment_max = avg;
+}
+
+/**
+ * @brief Process one completed block of samples
+ */
+static void finish_block(void) {
+    // Block average: centi-degrees → Q16 °C, relative to THERMAL_CENTER_C
+    int32_t avg = (int32_t)(((int64_t)block_sum_centi * Q16_ONE) /
+                            (100 * THERMAL_BLOCK_SAMPLES))
+                - THERMAL_CENTER_C * Q16_ONE;
+
+    if (avg > THERMAL_MAX_OFFSET_Q16 || avg < -THERMAL_MAX_OFFSET_Q16) {
+        // Far outside anything a working fridge does - not model data
+        block_disturbed = true;
+    }
+
+    if (block_disturbed) {
+        // Door opened or sensor error during this block: the model doesn't
+        // apply, so the segment ends here (pairs still pending are lost)
+        close_segment();
+        block_history = 0;
+        regime = THERMAL_REGIME_NONE;
+        pending_count = 0;
+        lag_count = 0;
+        return;
+    }
+
+    // Decide the regime from the change over the last two blocks
+    if (block_history >= 2) {
+        int32_t trend = avg - block_avg[1];
+        thermal_regime_t new_regime = regime;
+
+        if (trend < -THERMAL_TREND_Q16) {
+            new_regime = THERMAL_REGIME_COOLING;
+        } else if (trend > THERMAL_TREND_Q16) {
+            new_regime = THERMAL_REGIME_WARMING;
+        }
+
+        if (new_regime != regime) {
+            // Pairs still pending were probably already in the new regime,
+            // so close_segment() never sees them
+            pending_count = 0;
+            close_segment();
+            regime = new_regime;
+            start_segment(avg);
+        } else if (regime != THERMAL_REGIME_NONE) {
+            extend_segment(avg);
+        }
+    }
+
+    // Shift block history
+    block_avg[1] = block_avg[0];
+    block_avg[0] = avg;
+    if (block_history < 2) {
+        block_history++;
+    }
+}
+
+// =============================================================================
+// Public API implementation
+// =============================================================================
+
+void thermal_model_init(void) {
+    memset(estimators, 0, sizeof(estimators));
+    memset(&segment, 0, sizeof(segment));
+    segment_min = 0;
+    segment_max = 0;
+
+    block_sum_centi = 0;
+    block_count = 0;
+    block_disturbed = false;
+
+    memset(block_avg, 0, sizeof(block_avg));
+    block_history = 0;
+
+    memset(lag_avg, 0, sizeof(lag_avg));
+    lag_head = 0;
+    lag_count = 0;
+
+    regime = THERMAL_REGIME_NONE;
+    pending_count = 0;
+}
+
+bool thermal_model_add_sample(float temp_c, bool door_open, bool valid) {
+    if (door_open || !valid) {
+        block_disturbed = true;
+    } else {
+        // Round to nearest: truncating would add a code-dependent 0.01°C error
+        float centi = temp_c * 100.0f;
+        block_sum_centi += (int32_t)(centi + ((centi >= 0.0f) ? 0.5f : -0.5f));
+    }
+    block_count++;
+
+    if (block_count < THERMAL_BLOCK_SAMPLES) {
+        return false;
+    }
+
+    finish_block();
+
+    block_sum_centi = 0;
+    block_count = 0;
+    block_disturbed = false;
+    return true;
+}
+
+thermal_regime_t thermal_model_get_regime(void) {
+    return regime;
+}
+
+void thermal_model_get_fit(thermal_regime_t which, thermal_fit_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (which != THERMAL_REGIME_COOLING && which != THERMAL_REGIME_WARMING) {
+        return;
+    }
+
+    const rls_state_t *rls = &estimators[which];
+    out->updates = rls->updates;
+    if (rls->updates < THERMAL_MIN_UPDATES) {
+        return;
+    }
+
+    // Weighted means (Q16 °C), then the sums taken about them:
+    // czx = s1 * cov(z, x), czy = s1 * cov(z, y). Working about the means
+    // keeps the products small and avoids cancelling two huge terms.
+    int64_t mean_x = (rls->sx * Q16_ONE) / rls->s1;
+    int64_t mean_y = (rls->sy * Q16_ONE) / rls->s1;
+    int64_t czx = rls->szx - q16_round(rls->sz * mean_x);
+    int64_t czy = rls->szy - q16_round(rls->sz * mean_y);
+
+    // cov(z, x) is about var(x): too small = no information
+    if (czx * THERMAL_MIN_VARIANCE_DIV <= rls->s1) {
+        return;
+    }
+
+    // a = czy / czx. A decaying first-order system needs 0 < a < 1.
+    int64_t one_minus_a_num = czx - czy;  // (1 - a) * czx
+    if (czy <= 0 || one_minus_a_num <= 0) {
+        return;
+    }
+
+    // tau = lag / (1 - a), which must stay below THERMAL_MAX_TAU_S
+    // (checked before dividing - a nearly flat fit would overflow)
+    if (2 * (int64_t)THERMAL_LAG_S * czx >
+        (int64_t)(2 * THERMAL_MAX_TAU_S + THERMAL_LAG_S) * one_minus_a_num) {
+        return;
+    }
+
+    // T_inf = b / (1 - a) with b = mean_y - a * mean_x; the numerator is
+    // scaled by czx like the denominator. Bound it before dividing too.
+    int64_t t_inf_num = q16_round(mean_y * czx - mean_x * czy);
+    int64_t t_inf_lo = (int64_t)(-THERMAL_MAX_T_INF_C - THERMAL_CENTER_C) * one_minus_a_num;
+    int64_t t_inf_hi = (int64_t)(THERMAL_MAX_T_INF_C - THERMAL_CENTER_C) * one_minus_a_num;
+    if (t_inf_num < t_inf_lo || t_inf_num > t_inf_hi) {
+        return;
+    }
+
+    // The exact discrete decay is a = e^(-lag/tau), for which
+    // lag / (1 - a) = tau + lag/2 + lag^2 / (12 tau) + ...
+    int64_t tau_s = ((int64_t)THERMAL_LAG_S * czx) / one_minus_a_num
+                  - THERMAL_LAG_S / 2;
+    if (tau_s < 1) {
+        tau_s = 1;
+    }
+    tau_s -= ((int64_t)THERMAL_LAG_S * THERMAL_LAG_S) / (12 * tau_s);
+    if (tau_s < 1) {
+        tau_s = 1;
+    }
+
+    // Within +/-100°C, so the centi-degree value fits an int32_t
+    int64_t t_inf_centi_c = (t_inf_num * 100) / one_minus_a_num;
+
+    out->valid = true;
+    out->tau_s = (uint32_t)tau_s;
+    out->t_inf_centi_c = (int32_t)t_inf_centi_c + THERMAL_CENTER_C * 100;
+}
+
+bool thermal_model_get_cooling_capacity(int32_t *centi_c_per_hour) {
+    thermal_fit_t fit;
+    thermal_model_get_fit(THERMAL_REGIME_COOLING, &fit);
+
+    if (!fit.valid) {
+        return false;
+    }
+
+    // (T_threshold - T_inf) / tau, scaled from per-second to per-hour
+    int32_t threshold_centi_c = (int32_t)(TEMP_OK_MAX_C * 100.0f);
+    int64_t gap = (int64_t)threshold_centi_c - fit.t_inf_centi_c;
+    *centi_c_per_hour = (int32_t)((gap * 3600) / fit.tau_s);
+    return true;
+}
+
+const char* thermal_model_regime_to_string(thermal_regime_t which) {
+    switch (which) {
+        case THERMAL_REGIME_NONE:    return "none";
+        case THERMAL_REGIME_COOLING: return "cooling";
+        case THERMAL_REGIME_WARMING: return "warming";
+        default:                     return "unknown";
+    }
+}
@@ -0,0 +1,450 @@
+/**
+ * @file scenario_bench.c
+ * @brief Labelled alarm-scenario corpus and scoring for the status pipeline
+ *
+ * Why this exists:
+ * ----------------
+ * Changes to calculate_average(), determine_status() or HISTORY_BUFFER_SIZE
+ * are hard to judge by watching the serial output of one fridge. This tool
+ * links the real src/app_logic.c against a simulated hardware layer
+ * (sim_hal.c), replays a fixed set of scenarios through app_update(), and
+ * compares the reported status with a ground-truth label for every sample.
+ *
+ * Scenarios:
+ * ----------
+ * Each scenario is a function of time that produces, for every sample:
+ *   - the raw ADC code the sensor would read
+ *   - the debounced door state
+ *   - the status an ideal monitor would report (the label)
+ *
+ * The random noise uses a fixed seed per scenario, so two runs of the same
+ * firmware produce identical numbers and two firmware versions can be
+ * compared line by line.
+ *
+ * Scores:
+ * -------
+ *   accuracy     - Percentage of samples where reported status == label
+ *   detected     - Fault episodes (label != OK) where the reported status
+ *                  matched the label before the episode ended
+ *   ttd          - Time-to-detect: seconds from episode onset to the first
+ *                  matching report (mean and worst case)
+ *   false_alarms - Times the reported status switched to a non-OK value
+ *                  that the label did not call for
+ *   transitions  - Reported vs. labelled status changes. Extra reported
+ *                  transitions mean the status is flapping.
+ *
+ * Usage:
+ * ------
+ *   ./scenario_bench                 Run every scenario
+ *   ./scenario_bench adc_glitch      Run only the named scenario(s)
+ *
+ * The firmware's own telemetry printf() output is discarded so that only
+ * the score table reaches stdout.
+ */
+
+#include "app_logic.h"
+#include "config.h"
+#include "led_status.h"
+#include "sim_hal.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>  // For dup() (keeps the report separate from telemetry)
+
+// =============================================================================
+// Scenario definitions
+// =============================================================================
+
+/**
+ * One simulated sample: what the hardware reports, and what the
+ * status pipeline *should* conclude from it.
+ */
+typedef struct {
+    uint16_t raw;       // ADC code returned by the temperature read
+    bool door_open;     // Debounced door state
+    status_t expected;  // Ground-truth label for this sample
+} sample_t;
+
+typedef void (*scenario_fn)(uint32_t t_s, rng_t *rng, sample_t *out);
+
+typedef struct {
+    const char *name;
+    const char *description;
+    uint32_t duration_s;
+    scenario_fn generate;
+} scenario_t;
+
+// Compressor on+off cycle (40 minutes); the band is in sim_hal.h
+#define CYCLE_PERIOD_S      2400
+
+/**
+ * @brief Normal compressor cycling: a triangle wave between
+ *        CYCLE_LOW_C and CYCLE_HIGH_C
+ *
+ * The compressor runs for a third of the cycle (fast cooling),
+ * then the cabinet slowly warms for the remaining two thirds.
+ */
+static float cycling_temp(uint32_t t_s) {
+    uint32_t phase = t_s % CYCLE_PERIOD_S;
+    uint32_t cool_s = CYCLE_PERIOD_S / 3;
+    float span = CYCLE_HIGH_C - CYCLE_LOW_C;
+
+    if (phase < cool_s) {
+        return CYCLE_HIGH_C - span * ((float)phase / (float)cool_s);
+    }
+    return CYCLE_LOW_C + span * ((float)(phase - cool_s) /
+                                 (float)(CYCLE_PERIOD_S - cool_s));
+}
+
+/**
+ * @brief Label for a sample that has no sensor fault
+ *
+ * Door open wins over temperature, matching the firmware's priority order.
+ * Warm samples are only labelled TOO_WARM when the scenario says the
+ * excursion is a real problem (a defrost cycle is not).
+ */
+static status_t label_for(bool door_open, float true_temp_c, bool warm_is_fault) {
+    if (door_open) {
+        return STATUS_DOOR_OPEN;
+    }
+    if (warm_is_fault && true_temp_c > TEMP_OK_MAX_C) {
+        return STATUS_TOO_WARM;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Normal use: compressor cycling plus a 20-second door opening
+ * every 45 minutes. Nothing here should raise an alarm other than
+ * DOOR_OPEN while the door is actually open.
+ */
+static void scenario_normal_cycling(uint32_t t_s, rng_t *rng, sample_t *out) {
+    bool door = (t_s % 2700) >= 1800 && (t_s % 2700) < 1820;
+    float temp = cycling_temp(t_s) + (door ? 0.5f : 0.0f);
+
+    out->raw = sim_hal_temp_to_raw(temp + rng_noise(rng, SENSOR_NOISE_C));
+    out->door_open = door;
+    out->expected = label_for(door, temp, true);
+}
+
+/**
+ * Defrost: at 3 hours the evaporator heater runs for 20 minutes and the
+ * probe sees the air rise towards 8.5°C, then recover. Defrost is normal
+ * operation, so the label stays OK throughout.
+ */
+static void scenario_defrost(uint32_t t_s, rng_t *rng, sample_t *out) {
+    const uint32_t start_s = 3 * 3600;
+    const uint32_t length_s = 20 * 60;
+    float temp = cycling_temp(t_s);
+
+    if (t_s >= start_s) {
+        float dt = (float)(t_s - start_s);
+        // Heat-up towards 8.5°C while the heater runs, exponential recovery after
+        float base_at_start = cycling_temp(start_s);
+        float peak = 8.5f - (8.5f - base_at_start) * expf(-(float)length_s / 300.0f);
+        if (t_s < start_s + length_s) {
+            temp = 8.5f - (8.5f - base_at_start) * expf(-dt / 300.0f);
+        } else {
+            float since_end = dt - (float)length_s;
+            temp = temp + (peak - temp) * expf(-since_end / 360.0f);
+        }
+    }
+
+    out->raw = sim_hal_temp_to_raw(temp + rng_noise(rng, SENSOR_NOISE_C));
+    out->door_open = false;
+    out->expected = label_for(false, temp, false);
+}
+
+/**
+ * Long door-open: the door is left open for 15 minutes at the 1 hour mark.
+ * The cabinet warms towards 14°C and recovers slowly once closed. After the
+ * door closes the fridge really is too warm until it cools below threshold.
+ */
+static void scenario_long_door_open(uint32_t t_s, rng_t *rng, sample_t *out) {
+    const uint32_t open_s = 3600;
+    const uint32_t close_s = open_s + 15 * 60;
+    float temp = cycling_temp(t_s);
+    bool door = (t_s >= open_s) && (t_s < close_s);
+
+    if (t_s >= open_s) {
+        float base_at_open = cycling_temp(open_s);
+        float peak = 14.0f - (14.0f - base_at_open) *
+                     expf(-(float)(close_s - open_s) / 360.0f);
+        if (door) {
+            temp = 14.0f - (14.0f - base_at_open) *
+                   expf(-(float)(t_s - open_s) / 360.0f);
+        } else {
+            temp = temp + (peak - temp) * expf(-(float)(t_s - close_s) / 720.0f);
+        }
+    }
+
+    out->raw = sim_hal_temp_to_raw(temp + rng_noise(rng, SENSOR_NOISE_C));
+    out->door_open = door;
+    out->expected = label_for(door, temp, true);
+}
+
+/**
+ * Slow failure: the compressor stops at 1 hour and the cabinet drifts
+ * towards room temperature with a 5 hour time constant. TOO_WARM is
+ * expected as soon as the real temperature crosses TEMP_OK_MAX_C.
+ */
+static void scenario_slow_failure(uint32_t t_s, rng_t *rng, sample_t *out) {
+    const uint32_t fail_s = 3600;
+    float temp = cycling_temp(t_s);
+
+    if (t_s >= fail_s) {
+        float start = cycling_temp(fail_s);
+        temp = AMBIENT_C - (AMBIENT_C - start) *
+               expf(-(float)(t_s - fail_s) / (5.0f * 3600.0f));
+    }
+
+    out->raw = sim_hal_temp_to_raw(temp + rng_noise(rng, SENSOR_NOISE_C));
+    out->door_open = false;
+    out->expected = label_for(false, temp, true);
+}
+
+/**
+ * Sensor unplug: at 1 hour the probe cable is pulled. The ADC input
+ * floats near ground and reads codes 0-15 from then on.
+ */
+static void scenario_sensor_unplug(uint32_t t_s, rng_t *rng, sample_t *out) {
+    const uint32_t unplug_s = 3600;
+    float temp = cycling_temp(t_s);
+
+    out->door_open = false;
+    if (t_s >= unplug_s) {
+        out->raw = (uint16_t)(rng_next(rng) & 0x0F);
+        out->expected = STATUS_ERROR;
+    } else {
+        out->raw = sim_hal_temp_to_raw(temp + rng_noise(rng, SENSOR_NOISE_C));
+        out->expected = label_for(false, temp, true);
+    }
+}
+
+/**
+ * ADC glitches: normal cycling, but roughly every 7 minutes a single
+ * sample reads full-scale or zero (supply transient, loose connector).
+ * One bad sample is not a fault, so the label stays OK.
+ */
+static void scenario_adc_glitch(uint32_t t_s, rng_t *rng, sample_t *out) {
+    float temp = cycling_temp(t_s);
+
+    out->raw = sim_hal_temp_to_raw(temp + rng_noise(rng, SENSOR_NOISE_C));
+    if ((t_s % 420) == 200) {
+        out->raw = (rng_next(rng) & 1) ? (ADC_RESOLUTION - 1) : 0;
+    }
+    out->door_open = false;
+    out->expected = STATUS_OK;
+}
+
+static const scenario_t scenarios[] = {
+    { "normal_cycling", "compressor cycling + short door openings", 8 * 3600, scenario_normal_cycling },
+    { "defrost",        "20 min defrost heater at 3 h",             8 * 3600, scenario_defrost },
+    { "long_door_open", "door left open 15 min at 1 h",             4 * 3600, scenario_long_door_open },
+    { "slow_failure",   "compressor dies at 1 h, drifts to ambient", 8 * 3600, scenario_slow_failure },
+    { "sensor_unplug",  "probe cable pulled at 1 h",                4 * 3600, scenario_sensor_unplug },
+    { "adc_glitch",     "single-sample rail glitches every ~7 min", 8 * 3600, scenario_adc_glitch },
+};
+
+#define SCENARIO_COUNT  (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+// =============================================================================
+// Scoring
+// =============================================================================
+
+typedef struct {
+    uint32_t samples;
+    uint32_t correct;
+    uint32_t episodes;          // Labelled fault episodes (label != OK)
+    uint32_t detected;          // ...of which were matched before they ended
+    uint32_t ttd_total_s;       // Sum of time-to-detect over detected episodes
+    uint32_t ttd_max_s;         // Worst time-to-detect
+    uint32_t false_alarms;
+    uint32_t reported_transitions;
+    uint32_t expected_transitions;
+} score_t;
+
+/**
+ * @brief Replay one scenario through app_logic and score the result
+ *
+ * Time advances in SAMPLE_INTERVAL_MS steps, so every app_update() call
+ * takes exactly one sample - the same cadence as on the device.
+ */
+static void run_scenario(const scenario_t *sc, score_t *score) {
+    rng_t rng = { 0x9E3779B9u };
+    sample_t sample;
+    status_t prev_reported = STATUS_OK;
+    status_t prev_expected = STATUS_OK;
+
+    // Current labelled episode
+    bool in_episode = false;
+    bool episode_detected = false;
+    uint32_t episode_onset_s = 0;
+
+    memset(score, 0, sizeof(*score));
+    app_init();
+
+    for (uint32_t t_ms = 0; t_ms <= sc->duration_s * 1000u; t_ms += SAMPLE_INTERVAL_MS) {
+        uint32_t t_s = t_ms / 1000u;
+
+        sc->generate(t_s, &rng, &sample);
+        sim_hal_set_adc_raw(sample.raw);
+        sim_hal_set_door_open(sample.door_open);
+        app_update(t_ms);
+
+        status_t reported = sim_hal_last_status();
+        status_t expected = sample.expected;
+
+        // Episode bookkeeping: a new episode starts whenever the label
+        // changes to a non-OK value. Episodes that end undetected simply never bump
+        // score->detected.
+        if (expected != prev_expected || t_ms == 0) {
+            in_episode = (expected != STATUS_OK);
+            episode_detected = false;
+            episode_onset_s = t_s;
+            if (in_episode) {
+                score->episodes++;
+            }
+        }
+        if (in_episode && !episode_detected && reported == expected) {
+            uint32_t ttd_s = t_s - episode_onset_s;
+            episode_detected = true;
+            score->detected++;
+            score->ttd_total_s += ttd_s;
+            if (ttd_s > score->ttd_max_s) {
+                score->ttd_max_s = ttd_s;
+            }
+        }
+
+        // Transitions and false alarms. The first sample counts as a
+        // transition from OK, matching the firmware's power-on state.
+        if (reported != prev_reported) {
+            score->reported_transitions++;
+            if (reported != STATUS_OK && reported != expected) {
+                score->false_alarms++;
+            }
+        }
+        if (expected != prev_expected) {
+            score->expected_transitions++;
+        }
+
+        score->samples++;
+        if (reported == expected) {
+            score->correct++;
+        }
+
+        prev_reported = reported;
+        prev_expected = expected;
+    }
+}
+
+static void print_header(FILE *out) {
+    fprintf(out, "%-16s %8s %9s %9s %9s %9s %7s %12s\n",
+            "scenario", "samples", "accuracy", "detected",
+            "ttd_mean", "ttd_max", "false", "transitions");
+}
+
+static void print_score(FILE *out, const char *name, const score_t *s) {
+    char detected[16];
+    char ttd_mean[16];
+    char ttd_max[16];
+    char transitions[24];
+
+    snprintf(detected, sizeof(detected), "%u/%u",
+             (unsigned)s->detected, (unsigned)s->episodes);
+    if (s->detected > 0) {
+        snprintf(ttd_mean, sizeof(ttd_mean), "%.0fs",
+                 (double)s->ttd_total_s / (double)s->detected);
+        snprintf(ttd_max, sizeof(ttd_max), "%us", (unsigned)s->ttd_max_s);
+    } else {
+        snprintf(ttd_mean, sizeof(ttd_mean), "-");
+        snprintf(ttd_max, sizeof(ttd_max), "-");
+    }
+    snprintf(transitions, sizeof(transitions), "%u/%u",
+             (unsigned)s->reported_transitions,
+             (unsigned)s->expected_transitions);
+
+    fprintf(out, "%-16s %8u %8.2f%% %9s %9s %9s %7u %12s\n",
+            name,
+            (unsigned)s->samples,
+            s->samples ? 100.0 * (double)s->correct / (double)s->samples : 0.0,
+            detected, ttd_mean, ttd_max,
+            (unsigned)s->false_alarms,
+            transitions);
+}
+
+static void add_score(score_t *total, const score_t *s) {
+    total->samples += s->samples;
+    total->correct += s->correct;
+    total->episodes += s->episodes;
+    total->detected += s->detected;
+    total->ttd_total_s += s->ttd_total_s;
+    if (s->ttd_max_s > total->ttd_max_s) {
+        total->ttd_max_s = s->ttd_max_s;
+    }
+    total->false_alarms += s->false_alarms;
+    total->reported_transitions += s->reported_transitions;
+    total->expected_transitions += s->expected_transitions;
+}
+
+static bool is_selected(const char *name, int argc, char **argv) {
+    if (argc <= 1) {
+        return true;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    int selected = 0;
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        if (is_selected(scenarios[i].name, argc, argv)) {
+            selected++;
+        }
+    }
+    if (selected == 0) {
+        fprintf(stderr, "scenario_bench: no matching scenario. Available:\n");
+        for (int i = 0; i < SCENARIO_COUNT; i++) {
+            fprintf(stderr, "  %-16s %s\n", scenarios[i].name, scenarios[i].description);
+        }
+        return 1;
+    }
+
+    // Keep a handle on the real stdout for the report, then send the
+    // firmware's telemetry printf() calls to /dev/null
+    FILE *report = fdopen(dup(STDOUT_FILENO), "w");
+    if (report == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "scenario_bench: failed to redirect stdout\n");
+        return 1;
+    }
+
+    fprintf(report, "HISTORY_BUFFER_SIZE=%d SAMPLE_INTERVAL_MS=%d TEMP_OK_MAX_C=%.1f\n\n",
+            HISTORY_BUFFER_SIZE, SAMPLE_INTERVAL_MS, (double)TEMP_OK_MAX_C);
+    print_header(report);
+
+    score_t total;
+    memset(&total, 0, sizeof(total));
+
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        if (!is_selected(scenarios[i].name, argc, argv)) {
+            continue;
+        }
+        score_t score;
+        run_scenario(&scenarios[i], &score);
+        print_score(report, scenarios[i].name, &score);
+        add_score(&total, &score);
+    }
+
+    if (selected > 1) {
+        fprintf(report, "\n");
+        print_score(report, "TOTAL", &total);
+    }
+
+    fclose(report);
+    return 0;
+}
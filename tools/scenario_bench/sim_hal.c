@@ -0,0 +1,140 @@
+/**
+ * @file sim_hal.c
+ * @brief Host-side stand-ins for sensors.c, door_sensor.c and led_status.c
+ *
+ * Each function here matches the signature declared in the firmware
+ * headers, so app_logic.c links against it unchanged. The temperature
+ * conversion mirrors sensors.c: raw code → voltage → TMP36 formula,
+ * plus calibration, rounded to 0.01°C like the conversion table.
+ */
+
+#include "sim_hal.h"
+#include "config.h"
+#include "sensors.h"
+#include "door_sensor.h"
+#include "led_status.h"
+
+// =============================================================================
+// Deterministic noise
+// =============================================================================
+
+uint32_t rng_next(rng_t *rng) {
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+float rng_uniform(rng_t *rng) {
+    return (float)(rng_next(rng) >> 8) / 16777216.0f;
+}
+
+float rng_noise(rng_t *rng, float sigma) {
+    float sum = rng_uniform(rng) + rng_uniform(rng)
+              + rng_uniform(rng) + rng_uniform(rng);
+    return (sum - 2.0f) * sigma * 1.7320508f;  // sqrt(12 / 4) = sqrt(3)
+}
+
+// =============================================================================
+// Simulated inputs / captured outputs
+// =============================================================================
+
+static uint16_t adc_raw = 0;
+static bool door_open = false;
+static status_t led_status = STATUS_OK;
+
+uint16_t sim_hal_temp_to_raw(float temp_c) {
+    // Inverse of the TMP36 conversion in sensors.c, rounded to nearest code
+    float voltage = (temp_c / TMP36_SCALE) + TMP36_OFFSET_V;
+    float code = voltage * ((float)ADC_RESOLUTION / ADC_VREF) + 0.5f;
+
+    if (code < 0.0f) {
+        return 0;
+    }
+    if (code > (float)(ADC_RESOLUTION - 1)) {
+        return ADC_RESOLUTION - 1;
+    }
+    return (uint16_t)code;
+}
+
+void sim_hal_set_adc_raw(uint16_t raw) {
+    adc_raw = raw;
+}
+
+void sim_hal_set_door_open(bool open) {
+    door_open = open;
+}
+
+status_t sim_hal_last_status(void) {
+    return led_status;
+}
+
+// =============================================================================
+// sensors.h
+// =============================================================================
+
+void sensors_init(void) {
+}
+
+float sensors_read_temperature_c(void) {
+    // Same math and 0.01°C rounding as build_conversion_table() in sensors.c
+    float voltage = (float)adc_raw * (ADC_VREF / (float)ADC_RESOLUTION);
+    float temp_c = (voltage - TMP36_OFFSET_V) * TMP36_SCALE + TEMP_CALIBRATION_OFFSET_C;
+    float centi = temp_c * 100.0f;
+    centi += (centi >= 0.0f) ? 0.5f : -0.5f;
+    return (float)(int16_t)centi * 0.01f;
+}
+
+bool sensors_is_reading_valid(float temp_c) {
+    return (temp_c >= TEMP_VALID_MIN_C) && (temp_c <= TEMP_VALID_MAX_C);
+}
+
+// =============================================================================
+// door_sensor.h
+// =============================================================================
+
+void door_sensor_init(void) {
+}
+
+void door_sensor_update(uint32_t millis_since_boot) {
+    (void)millis_since_boot;
+}
+
+bool door_sensor_is_open(void) {
+    return door_open;
+}
+
+bool door_sensor_raw_state(void) {
+    return door_open;
+}
+
+// =============================================================================
+// led_status.h
+// =============================================================================
+
+void led_status_init(void) {
+}
+
+void led_status_set(status_t status) {
+    led_status = status;
+}
+
+status_t led_status_get(void) {
+    return led_status;
+}
+
+void led_status_update(uint32_t millis_since_boot) {
+    (void)millis_since_boot;
+}
+
+const char* led_status_to_string(status_t status) {
+    switch (status) {
+        case STATUS_OK:        return "OK";
+        case STATUS_DOOR_OPEN: return "DOOR_OPEN";
+        case STATUS_TOO_WARM:  return "TOO_WARM";
+        case STATUS_ERROR:     return "ERROR";
+        default:               return "UNKNOWN";
+    }
+}
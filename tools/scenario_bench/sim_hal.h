@@ -0,0 +1,96 @@
+/**
+ * @file sim_hal.h
+ * @brief Simulated hardware layer for running app_logic.c on a host PC
+ *
+ * The firmware modules sensors.c, door_sensor.c and led_status.c talk to
+ * the RP2040 hardware through the Pico SDK, so they can't be compiled on a
+ * desktop machine. app_logic.c, however, only talks to them through their
+ * headers. This file provides host-side replacements for those headers so
+ * the real status pipeline can be driven by scripted inputs.
+ *
+ * The scenario runner sets the inputs before each call to app_update():
+ *
+ *   sim_hal_set_adc_raw(sim_hal_temp_to_raw(4.2f));
+ *   sim_hal_set_door_open(false);
+ *   app_update(millis);
+ *   status_t s = sim_hal_last_status();
+ */
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "led_status.h"  // For status_t enum
+
+// =============================================================================
+// Shared fridge model parameters
+// =============================================================================
+
+#define CYCLE_LOW_C         2.5f    // Air temp when compressor switches off
+#define CYCLE_HIGH_C        5.0f    // Air temp when compressor switches on
+#define SENSOR_NOISE_C      0.1f    // Electrical noise at the ADC input
+#define AMBIENT_C           22.0f   // Room temperature
+
+// =============================================================================
+// Deterministic noise
+// =============================================================================
+
+/**
+ * Small deterministic PRNG (xorshift32) so runs are reproducible
+ * across machines and C libraries.
+ */
+typedef struct {
+    uint32_t state;
+} rng_t;
+
+/**
+ * @brief Next raw 32-bit value
+ */
+uint32_t rng_next(rng_t *rng);
+
+/**
+ * @brief Uniform value in [0, 1)
+ */
+float rng_uniform(rng_t *rng);
+
+/**
+ * @brief Approximately Gaussian noise (sum of 4 uniforms) with the given sigma
+ */
+float rng_noise(rng_t *rng, float sigma);
+
+// =============================================================================
+// Simulated hardware
+// =============================================================================
+
+/**
+ * @brief Convert a temperature to the ADC code a TMP36 would produce
+ *
+ * Uses the same constants as sensors.c (ADC_VREF, TMP36_OFFSET_V, ...)
+ * so the simulated readings have the real 12-bit quantization.
+ *
+ * @param temp_c Temperature in degrees Celsius
+ * @return ADC code, clamped to 0..ADC_RESOLUTION-1
+ */
+uint16_t sim_hal_temp_to_raw(float temp_c);
+
+/**
+ * @brief Set the raw ADC code returned by the next temperature read
+ *
+ * Scenarios pass codes directly (rather than temperatures) so they can
+ * model faults such as an unplugged probe (code 0) or a rail glitch (4095).
+ */
+void sim_hal_set_adc_raw(uint16_t raw);
+
+/**
+ * @brief Set the debounced door state reported to app_logic
+ */
+void sim_hal_set_door_open(bool open);
+
+/**
+ * @brief Get the last status app_logic passed to led_status_set()
+ */
+status_t sim_hal_last_status(void);
+
+#endif // SIM_HAL_H
@@ -0,0 +1,183 @@
+/**
+ * @file thermal_bench.c
+ * @brief Accuracy check for the thermal model against a simulated fridge
+ *
+ * Why this exists:
+ * ----------------
+ * thermal_model.c fits tau and T_inf from quantized, noisy ADC readings
+ * of a fridge that only ever spans a couple of degrees. Whether that fit
+ * is any good can't be judged from the serial output of a real fridge,
+ * because nobody knows its true time constants. Here they are known.
+ *
+ * The Simulated Fridge:
+ * ---------------------
+ * A first-order cabinet with a thermostat: the compressor switches on at
+ * CYCLE_HIGH_C and off at CYCLE_LOW_C, the same band scenario_bench
+ * uses (both come from sim_hal.h). Each regime follows the exact
+ * exponential towards its own T_inf with its own tau (the TRUE_* values
+ * below). Every sample goes through sim_hal_temp_to_raw() and the
+ * simulated sensors_read_temperature_c(), so the model sees the same
+ * 12-bit ADC quantization and 0.01°C table rounding as on the device.
+ *
+ * Cases:
+ * ------
+ *   clean      - no noise: quantization only
+ *   noisy      - SENSOR_NOISE_C Gaussian noise, several seeds
+ *   noisy+door - as noisy, plus a 20-second door opening every 45 minutes
+ *
+ * Each case runs for BENCH_DAYS days. The table shows the final fit and
+ * its error against the truth, plus how far tau_warm swung over the last
+ * day (the slowest, worst conditioned estimate).
+ *
+ * Usage:
+ * ------
+ *   ./thermal_bench
+ */
+
+#include "config.h"
+#include "sensors.h"
+#include "sim_hal.h"
+#include "thermal_model.h"
+
+#include <math.h>
+#include <stdio.h>
+
+// =============================================================================
+// Simulated fridge
+// =============================================================================
+
+// True model parameters the fit should recover
+#define TRUE_TAU_COOL_S     600.0f  // Compressor running
+#define TRUE_TINF_COOL_C    -2.0f
+#define TRUE_TAU_WARM_S     5400.0f // Compressor off
+#define TRUE_TINF_WARM_C    AMBIENT_C
+
+#define BENCH_DAYS          7
+#define BENCH_SEEDS         5
+
+typedef struct {
+    const char *name;
+    float noise_c;
+    bool door;
+    int seed;       // 0 for the noise-free case
+} bench_case_t;
+
+typedef struct {
+    thermal_fit_t cool;
+    thermal_fit_t warm;
+    uint32_t warm_min_s;    // tau_warm range over the last day
+    uint32_t warm_max_s;
+} bench_result_t;
+
+/**
+ * @brief Run the simulated fridge for BENCH_DAYS and collect the fits
+ */
+static void run_case(const bench_case_t *bc, bench_result_t *result) {
+    const float dt_s = (float)SAMPLE_INTERVAL_MS / 1000.0f;
+    const float decay_cool = expf(-dt_s / TRUE_TAU_COOL_S);
+    const float decay_warm = expf(-dt_s / TRUE_TAU_WARM_S);
+    const uint32_t end_s = BENCH_DAYS * 86400u;
+    const uint32_t last_day_s = end_s - 86400u;
+
+    rng_t rng = { 0x9E3779B9u * (uint32_t)(bc->seed + 1) };
+    float temp = CYCLE_HIGH_C;
+    bool compressor_on = true;
+
+    result->warm_min_s = UINT32_MAX;
+    result->warm_max_s = 0;
+    thermal_model_init();
+
+    for (uint32_t t_ms = 0; t_ms < end_s * 1000u; t_ms += SAMPLE_INTERVAL_MS) {
+        uint32_t t_s = t_ms / 1000u;
+
+        // Thermostat, then one exact first-order step
+        if (compressor_on && temp <= CYCLE_LOW_C) {
+            compressor_on = false;
+        } else if (!compressor_on && temp >= CYCLE_HIGH_C) {
+            compressor_on = true;
+        }
+        if (compressor_on) {
+            temp = TRUE_TINF_COOL_C + (temp - TRUE_TINF_COOL_C) * decay_cool;
+        } else {
+            temp = TRUE_TINF_WARM_C + (temp - TRUE_TINF_WARM_C) * decay_warm;
+        }
+
+        bool door = bc->door && (t_s % 2700) >= 1800 && (t_s % 2700) < 1820;
+        float noise = (bc->noise_c > 0.0f) ? rng_noise(&rng, bc->noise_c) : 0.0f;
+        float reading_temp = temp + (door ? 0.5f : 0.0f) + noise;
+
+        sim_hal_set_adc_raw(sim_hal_temp_to_raw(reading_temp));
+        float reading = sensors_read_temperature_c();
+
+        if (thermal_model_add_sample(reading, door, sensors_is_reading_valid(reading))
+            && t_s >= last_day_s) {
+            thermal_fit_t warm;
+            thermal_model_get_fit(THERMAL_REGIME_WARMING, &warm);
+            if (warm.valid) {
+                if (warm.tau_s < result->warm_min_s) result->warm_min_s = warm.tau_s;
+                if (warm.tau_s > result->warm_max_s) result->warm_max_s = warm.tau_s;
+            }
+        }
+    }
+
+    thermal_model_get_fit(THERMAL_REGIME_COOLING, &result->cool);
+    thermal_model_get_fit(THERMAL_REGIME_WARMING, &result->warm);
+}
+
+// =============================================================================
+// Report
+// =============================================================================
+
+/**
+ * @brief Format one tau / T_inf estimate with its error against the truth
+ */
+static void print_fit(const thermal_fit_t *fit, float true_tau_s, float true_tinf_c) {
+    if (!fit->valid) {
+        printf(" %7s %7s %7s %7s", "-", "-", "-", "-");
+        return;
+    }
+    float tinf_c = (float)fit->t_inf_centi_c / 100.0f;
+    printf(" %6lus %+6.1f%% %6.2fC %+6.2fC",
+           (unsigned long)fit->tau_s,
+           100.0 * ((double)fit->tau_s - (double)true_tau_s) / (double)true_tau_s,
+           (double)tinf_c, (double)(tinf_c - true_tinf_c));
+}
+
+int main(void) {
+    bench_case_t cases[2 + 2 * BENCH_SEEDS];
+    int count = 0;
+
+    cases[count++] = (bench_case_t){ "clean", 0.0f, false, 0 };
+    for (int seed = 1; seed <= BENCH_SEEDS; seed++) {
+        cases[count++] = (bench_case_t){ "noisy", SENSOR_NOISE_C, false, seed };
+    }
+    for (int seed = 1; seed <= BENCH_SEEDS; seed++) {
+        cases[count++] = (bench_case_t){ "noisy+door", SENSOR_NOISE_C, true, seed };
+    }
+
+    // The firmware's thermal_model has no printf(), so stdout is the report
+    printf("THERMAL_BLOCK_SAMPLES=%d THERMAL_LAG_BLOCKS=%d THERMAL_FORGETTING_SHIFT=%d, %d days\n",
+           THERMAL_BLOCK_SAMPLES, THERMAL_LAG_BLOCKS, THERMAL_FORGETTING_SHIFT, BENCH_DAYS);
+    printf("truth: tau_cool=%.0fs tinf_cool=%.2fC tau_warm=%.0fs tinf_warm=%.2fC\n\n",
+           (double)TRUE_TAU_COOL_S, (double)TRUE_TINF_COOL_C,
+           (double)TRUE_TAU_WARM_S, (double)TRUE_TINF_WARM_C);
+    printf("%-11s %4s %7s %7s %7s %7s %7s %7s %7s %7s %13s\n",
+           "case", "seed", "tau_c", "err", "tinf_c", "err",
+           "tau_w", "err", "tinf_w", "err", "tau_w 24h");
+
+    for (int i = 0; i < count; i++) {
+        bench_result_t result;
+        run_case(&cases[i], &result);
+
+        printf("%-11s %4d", cases[i].name, cases[i].seed);
+        print_fit(&result.cool, TRUE_TAU_COOL_S, TRUE_TINF_COOL_C);
+        print_fit(&result.warm, TRUE_TAU_WARM_S, TRUE_TINF_WARM_C);
+        if (result.warm_max_s > 0) {
+            printf(" %6lu-%-6lu\n", (unsigned long)result.warm_min_s,
+                   (unsigned long)result.warm_max_s);
+        } else {
+            printf(" %13s\n", "-");
+        }
+    }
+    return 0;
+}